@@ -0,0 +1,130 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+
+#include "simulation.h"
+#include "verify.h"
+
+using namespace std;
+
+// every heap allocation in the program goes through here
+static long allocations = 0;
+
+// upper bound on ticks; every layout stops growing well before this
+static const int timeLimit = 500;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// write a layout as a region CSV that readRegion() can load
+static void writeRegion(const filesystem::path& path, const vector<vector<Cell>>& layout) {
+    ofstream file(path);
+    for (const auto& row : layout) {
+        for (size_t y = 0; y < row.size(); y++) {
+            file << (y > 0 ? "," : "") << static_cast<char>(row[y].zone);
+        }
+        file << "\n";
+    }
+}
+
+// small and mostly industrial with residential to staff it, so factories keep
+// growing after the first tick and raise pollution on cells already polluted
+static vector<vector<Cell>> industrialLayout(mt19937& rng) {
+    uniform_int_distribution<int> size(5, 8);
+    int rows = size(rng), cols = size(rng);
+    const ZoneType zones[] = {INDUSTRIAL, RESIDENTIAL, ROAD, POWERLINE, COMMERCIAL};
+    discrete_distribution<int> pick({50, 30, 8, 7, 5});
+
+    vector<vector<Cell>> layout(rows, vector<Cell>(cols));
+    for (auto& row : layout) {
+        for (auto& cell : row) {
+            cell.zone = zones[pick(rng)];
+        }
+    }
+    layout[0][0].zone = POWERPLANT;
+    return layout;
+}
+
+// run one config: warm up with the first tick, then every later tick until growth stops must not allocate
+static bool checkConfig(const filesystem::path& configPath, const string& name, const string& kind, int layout) {
+    Simulation sim;
+
+    // initialization prints the config and map; keep that out of the report
+    streambuf* out = cout.rdbuf(nullptr);
+    sim.initializeSim(configPath.string());
+    bool hasChanges = sim.step();
+    cout.rdbuf(out);
+    cout.clear();
+
+    while (hasChanges && sim.getCurrentTick() < timeLimit) {
+        long before = allocations;
+        hasChanges = sim.step();
+        if (allocations != before) {
+            cerr << name << ", " << kind << " layout " << layout << ": tick " << sim.getCurrentTick()
+                 << " made " << allocations - before << " heap allocations" << endl;
+            return false;
+        }
+    }
+    if (hasChanges) {
+        cerr << name << ", " << kind << " layout " << layout << ": still growing at tick " << timeLimit << endl;
+        return false;
+    }
+    return true;
+}
+
+// main
+int main() {
+    filesystem::path dir = filesystem::temp_directory_path() / "simcity_alloccheck";
+    filesystem::create_directories(dir);
+
+    // config lines for each mode that runs code in the tick path
+    const string modes[][2] = {
+        {"scan matching", ""},
+        {"nearest matching", "Matching Mode:nearest\n"},
+        {"history and overview", "Matching Mode:nearest\nHistory File:history.bin\nKeyframe Interval:5\nOverview Zoom:2\n"}
+    };
+
+    // road grids, fuzzed layouts and dense industrial layouts, 40 of each
+    vector<vector<Cell>> (*const generators[])(mt19937&) = {generateLayout, fuzzLayout, industrialLayout};
+    const string kinds[] = {"generated", "fuzzed", "industrial"};
+
+    mt19937 rng(1);
+    bool ok = true;
+    for (int layout = 0; layout < 120 && ok; layout++) {
+        writeRegion(dir / "region.csv", generators[layout % 3](rng));
+
+        for (const auto& [name, extra] : modes) {
+            ofstream config(dir / "config.txt");
+            config << "Region Layout:region.csv\nTime Limit:" << timeLimit << "\nRefresh Rate:1\n" << extra;
+            config.close();
+
+            if (!checkConfig(dir / "config.txt", name, kinds[layout % 3], layout)) {
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    filesystem::remove_all(dir);
+    if (ok) {
+        cout << "No heap allocations after the first tick (120 layouts, 3 modes)." << endl;
+    }
+    return ok ? 0 : 1;
+}
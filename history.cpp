@@ -0,0 +1,163 @@
+#include "history.h"
+
+#include <stdexcept>
+
+// record kinds stored in the first byte of each tick
+static const char KEYFRAME = 'K';
+static const char DELTA = 'D';
+
+// helper to compare every stored field of two cells
+static bool sameCell(const Cell& a, const Cell& b) {
+    return a.zone == b.zone && a.population == b.population && a.pollution == b.pollution &&
+           a.availableWorkers == b.availableWorkers && a.availableGoods == b.availableGoods &&
+           a.isAdjacentToPowerLine == b.isAdjacentToPowerLine && a.isPowered == b.isPowered;
+}
+
+//constructor, creates (or truncates) the history file
+RunHistory::RunHistory(const std::string& path, int rows, int cols, int keyframeInterval)
+    : rows(rows), cols(cols), keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1) {
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open the history file: " + path);
+    }
+
+    // header: map size and keyframe interval so the file is self-describing
+    int header[3] = {rows, cols, this->keyframeInterval};
+    file.write("SCH1", 4);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+void RunHistory::writeCell(const Cell& cell) {
+    int values[4] = {cell.population, cell.pollution, cell.availableWorkers, cell.availableGoods};
+    char flags[3] = {static_cast<char>(cell.zone), cell.isAdjacentToPowerLine, cell.isPowered};
+    file.write(reinterpret_cast<const char*>(values), sizeof(values));
+    file.write(flags, sizeof(flags));
+}
+
+Cell RunHistory::readCell() {
+    int values[4];
+    char flags[3];
+    file.read(reinterpret_cast<char*>(values), sizeof(values));
+    file.read(flags, sizeof(flags));
+
+    Cell cell;
+    cell.population = values[0];
+    cell.pollution = values[1];
+    cell.availableWorkers = values[2];
+    cell.availableGoods = values[3];
+    cell.zone = static_cast<ZoneType>(flags[0]);
+    cell.isAdjacentToPowerLine = flags[1];
+    cell.isPowered = flags[2];
+    return cell;
+}
+
+void RunHistory::reserve(int ticks) {
+    offsets.reserve(ticks);
+}
+
+void RunHistory::record(const RegionMap& grid) {
+    int tick = offsets.size();
+    file.seekp(0, std::ios::end);
+    offsets.push_back(file.tellp());
+
+    if (tick % keyframeInterval == 0) {
+        // keyframe: every cell in row-major order
+        int count = rows * cols;
+        file.put(KEYFRAME);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        last.resize(count);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                writeCell(grid[x][y]);
+                last[x * cols + y] = grid[x][y];
+            }
+        }
+    } else {
+        // delta: only the cells that changed since the previous tick
+        std::streamoff countPos = static_cast<std::streamoff>(file.tellp()) + 1;
+        int count = 0;
+        file.put(DELTA);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                int index = x * cols + y;
+                if (!sameCell(grid[x][y], last[index])) {
+                    file.write(reinterpret_cast<const char*>(&index), sizeof(index));
+                    writeCell(grid[x][y]);
+                    last[index] = grid[x][y];
+                    count++;
+                }
+            }
+        }
+        // go back and fill in the number of changed cells
+        file.seekp(countPos);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Failed to write to the history file.");
+    }
+}
+
+int RunHistory::tickCount() const {
+    return offsets.size();
+}
+
+// apply one stored tick (keyframe or delta) onto grid
+void RunHistory::applyRecord(int tick, std::vector<Cell>& grid) {
+    file.seekg(offsets[tick]);
+    char kind = file.get();
+    int count = 0;
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+    if (kind == KEYFRAME) {
+        for (int i = 0; i < count; i++) {
+            grid[i] = readCell();
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            int index = 0;
+            file.read(reinterpret_cast<char*>(&index), sizeof(index));
+            grid[index] = readCell();
+        }
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed to read from the history file.");
+    }
+}
+
+std::vector<std::vector<Cell>> RunHistory::seek(int tick) {
+    if (tick < 0 || tick >= tickCount()) {
+        throw std::out_of_range("Tick " + std::to_string(tick) + " is not in the run history.");
+    }
+
+    // start from the keyframe at or before tick and replay deltas up to it
+    std::vector<Cell> grid(rows * cols);
+    int keyframe = tick - tick % keyframeInterval;
+    for (int t = keyframe; t <= tick; t++) {
+        applyRecord(t, grid);
+    }
+
+    std::vector<std::vector<Cell>> result(rows);
+    for (int x = 0; x < rows; x++) {
+        result[x].assign(grid.begin() + x * cols, grid.begin() + (x + 1) * cols);
+    }
+    return result;
+}
+
+std::vector<CellChange> RunHistory::diff(int fromTick, int toTick) {
+    std::vector<std::vector<Cell>> before = seek(fromTick);
+    std::vector<std::vector<Cell>> after = seek(toTick);
+
+    std::vector<CellChange> changes;
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            if (!sameCell(before[x][y], after[x][y])) {
+                changes.push_back({x, y, before[x][y], after[x][y]});
+            }
+        }
+    }
+    return changes;
+}
@@ -0,0 +1,47 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include<fstream>
+#include<string>
+#include<vector>
+
+#include "simulation.h"
+
+// one cell that differs between two ticks
+struct CellChange {
+    int x, y;
+    Cell before;
+    Cell after;
+};
+
+// Append-only run history: a full keyframe every keyframeInterval ticks and
+// per-tick deltas (changed cells only) in between. Only the byte offset of each
+// tick and the last recorded grid are kept in memory.
+class RunHistory{
+private:
+    std::fstream file;
+    int rows, cols;
+    int keyframeInterval;
+    std::vector<std::streamoff> offsets;  // file offset of each tick's record
+    std::vector<Cell> last;               // last recorded grid, row-major
+
+    void writeCell(const Cell& cell);
+    Cell readCell();
+    void applyRecord(int tick, std::vector<Cell>& grid);
+
+public:
+    RunHistory(const std::string& path, int rows, int cols, int keyframeInterval);
+
+    // size the tick index up front so recording does not allocate
+    void reserve(int ticks);
+    // append the grid as the next tick (tick 0 is the first call)
+    void record(const RegionMap& grid);
+    int tickCount() const;
+
+    // rebuild the grid at tick, replaying at most keyframeInterval - 1 deltas
+    std::vector<std::vector<Cell>> seek(int tick);
+    // cells whose state differs between two recorded ticks
+    std::vector<CellChange> diff(int fromTick, int toTick);
+};
+
+#endif
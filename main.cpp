@@ -3,11 +3,29 @@
 #include <fstream>
 
 #include "simulation.h"
+#include "verify.h"
 
 using namespace std;
 
 // main
-int main() {
+int main(int argc, char* argv[]) {
+    // verification mode: ./main --verify [layouts] [seed]
+    if (argc > 1 && string(argv[1]) == "--verify") {
+        int layouts = 200;
+        unsigned long seed = 1;
+        try {
+            if (argc > 2) layouts = stoi(argv[2]);
+            if (argc > 3) seed = stoul(argv[3]);
+        } catch (const logic_error&) { // invalid_argument or out_of_range
+            layouts = 0;
+        }
+        if (layouts <= 0 || argc > 4) {
+            cerr << "Usage: " << argv[0] << " --verify [layouts > 0] [seed]" << endl;
+            return 2;
+        }
+        return verifyEngines(layouts, seed, 30) ? 0 : 1;
+    }
+
     cout << "\nSIM CITY SIMULATION - Team 1:\n" << endl;
 
     string configFilePath;
@@ -0,0 +1,142 @@
+#include "overview.h"
+
+#include <algorithm>
+#include <string>
+
+// zone types in the order used by Tile::zoneCounts (also the tie-break order)
+static const ZoneType zoneOrder[8] = {
+    RESIDENTIAL, COMMERCIAL, INDUSTRIAL, POWERPLANT, POWERLINE, POWERLINE_OVER_ROAD, ROAD, EMPTY
+};
+
+static int zoneSlot(ZoneType zone) {
+    for (int i = 0; i < 8; i++) {
+        if (zoneOrder[i] == zone) return i;
+    }
+    return 7;
+}
+
+// most common non-empty zone in the tile, or EMPTY if it has none
+static ZoneType dominantZone(const Tile& tile) {
+    int best = 7;
+    for (int i = 0; i < 7; i++) {
+        if (tile.zoneCounts[i] > 0 && (best == 7 || tile.zoneCounts[i] > tile.zoneCounts[best])) {
+            best = i;
+        }
+    }
+    return zoneOrder[best];
+}
+
+// population in at most 4 characters (e.g. 7, 512, 12k, 999k, 3M, 2G)
+static std::string compactCount(int value) {
+    if (value < 1000) return std::to_string(value);
+    if (value < 1000000) return std::to_string(value / 1000) + "k";
+    if (value < 1000000000) return std::to_string(value / 1000000) + "M";
+    return std::to_string(value / 1000000000) + "G";
+}
+
+//constructor, builds every level from the grid
+OverviewRenderer::OverviewRenderer(const RegionMap& grid) {
+    int rows = grid.size();
+    int cols = grid.empty() ? 0 : grid[0].size();
+
+    // add levels until one tile covers the whole map
+    do {
+        levelRows.push_back(rows);
+        levelCols.push_back(cols);
+        levels.emplace_back(static_cast<size_t>(rows) * cols);
+        rows = (rows + 1) / 2;
+        cols = (cols + 1) / 2;
+    } while (levelRows.back() > 1 || levelCols.back() > 1);
+
+    for (int x = 0; x < levelRows[0]; x++) {
+        for (int y = 0; y < levelCols[0]; y++) {
+            Tile& tile = levels[0][x * levelCols[0] + y];
+            tile.zoneCounts[zoneSlot(grid[x][y].zone)] = 1;
+            tile.population = grid[x][y].population;
+            tile.pollution = grid[x][y].pollution;
+        }
+    }
+
+    for (int level = 1; level < levelCount(); level++) {
+        for (int x = 0; x < levelRows[level]; x++) {
+            for (int y = 0; y < levelCols[level]; y++) {
+                rebuildTile(level, x, y);
+            }
+        }
+    }
+}
+
+// recompute a tile from its (up to four) children one level down
+void OverviewRenderer::rebuildTile(int level, int x, int y) {
+    Tile tile;
+    int childRows = levelRows[level - 1];
+    int childCols = levelCols[level - 1];
+
+    for (int cx = 2 * x; cx <= 2 * x + 1 && cx < childRows; cx++) {
+        for (int cy = 2 * y; cy <= 2 * y + 1 && cy < childCols; cy++) {
+            const Tile& child = levels[level - 1][cx * childCols + cy];
+            for (int i = 0; i < 8; i++) {
+                tile.zoneCounts[i] += child.zoneCounts[i];
+            }
+            tile.population += child.population;
+            tile.pollution = std::max(tile.pollution, child.pollution);
+        }
+    }
+
+    levels[level][x * levelCols[level] + y] = tile;
+}
+
+void OverviewRenderer::update(int x, int y, const Cell& cell) {
+    Tile& tile = levels[0][x * levelCols[0] + y];
+    tile = Tile();
+    tile.zoneCounts[zoneSlot(cell.zone)] = 1;
+    tile.population = cell.population;
+    tile.pollution = cell.pollution;
+
+    for (int level = 1; level < levelCount(); level++) {
+        x /= 2;
+        y /= 2;
+        rebuildTile(level, x, y);
+    }
+}
+
+int OverviewRenderer::levelCount() const {
+    return levels.size();
+}
+
+void OverviewRenderer::render(std::ostream& out, int zoom, int top, int left, int height, int width) const {
+    // clamp the zoom and window to the tiles that exist at that level
+    zoom = std::clamp(zoom, 0, levelCount() - 1);
+    int rows = levelRows[zoom];
+    int cols = levelCols[zoom];
+    top = std::clamp(top, 0, rows);
+    left = std::clamp(left, 0, cols);
+    height = std::clamp(height, 0, rows - top);
+    width = std::clamp(width, 0, cols - left);
+
+    // Define cell width for consistent formatting (same as printMap)
+    const int cellWidth = 6;  // zone letter, up to 4 population characters, '*'
+
+    out << "Overview: zoom " << zoom << " (" << (1 << zoom) << "x" << (1 << zoom)
+        << " cells per tile), tiles " << top << "-" << top + height - 1 << " x "
+        << left << "-" << left + width - 1 << " of " << rows << " x " << cols << "\n";
+    out << "==" << std::string(width * cellWidth, '=') << "==\n";
+
+    for (int x = top; x < top + height; x++) {
+        out << "||";
+        for (int y = left; y < left + width; y++) {
+            const Tile& tile = levels[zoom][x * cols + y];
+
+            // dominant zone, summed population, '*' if any cell is polluted
+            std::string content(1, static_cast<char>(dominantZone(tile)));
+            if (tile.population > 0) content += compactCount(tile.population);
+            if (tile.pollution > 0) content += '*';
+
+            int padding = (cellWidth - content.size()) / 2;
+            out << std::string(padding, ' ') << content << std::string(cellWidth - padding - content.size(), ' ');
+        }
+        out << "||\n";
+    }
+
+    out << "==" << std::string(width * cellWidth, '=') << "==" << std::endl;
+}
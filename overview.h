@@ -0,0 +1,38 @@
+#ifndef OVERVIEW_H
+#define OVERVIEW_H
+
+#include<ostream>
+#include<vector>
+
+#include "simulation.h"
+
+// summary of a square block of cells at one zoom level
+struct Tile {
+    int zoneCounts[8] = {};  // cells of each zone type, indexed by zoneSlot()
+    int population = 0;      // summed population
+    int pollution = 0;       // max pollution
+};
+
+// Mip pyramid of tiles for drawing maps larger than the terminal. Level 0 is one
+// tile per cell and each level above halves both dimensions, so a tile at level
+// l covers a 2^l x 2^l block. Changed cells are pushed up one parent per level.
+class OverviewRenderer{
+private:
+    std::vector<std::vector<Tile>> levels;  // row-major tiles per level
+    std::vector<int> levelRows, levelCols;
+
+    void rebuildTile(int level, int x, int y);
+
+public:
+    OverviewRenderer(const RegionMap& grid);
+
+    // refresh one cell and its ancestors
+    void update(int x, int y, const Cell& cell);
+
+    int levelCount() const;
+
+    // draw a height x width window of tiles at the given zoom, starting at tile (top, left)
+    void render(std::ostream& out, int zoom, int top, int left, int height, int width) const;
+};
+
+#endif
@@ -0,0 +1,379 @@
+#include "reference.h"
+
+#include <algorithm>
+#include <queue>
+
+/*********************************
+FROZEN RULES - copied unchanged from the original engine. Do not optimize or
+"fix" anything below: the verification mode treats this as ground truth.
+*********************************/
+
+//constructor
+ReferenceEngine::ReferenceEngine(const std::vector<std::vector<Cell>>& layout) : regionMap(layout) {}
+
+const std::vector<std::vector<Cell>>& ReferenceEngine::getMap() const {
+    return regionMap;
+}
+
+//**POWER FUNCTIONS**//
+// helper function to count adjacent cells with a minimum population
+int ReferenceEngine::countAdjPop(int x, int y, int minPopulation) const {
+    int count = 0;
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            if (dx == 0 && dy == 0) continue;
+            int nx = x + dx;
+            int ny = y + dy;
+            if (nx >= 0 && static_cast<size_t>(nx) < regionMap.size() && ny >= 0 && static_cast<size_t>(ny) < regionMap[0].size()) {
+                if (regionMap[nx][ny].population >= minPopulation) {
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// helper function to check if a cell is adjacent to a power line
+bool ReferenceEngine::hasAdjPower(int x, int y) const {
+    std::vector<std::pair<int, int>> directions = {
+        {-1, 0}, {1, 0}, {0, -1}, {0, 1},  // Up, Down, Left, Right
+        {-1, -1}, {-1, 1}, {1, -1}, {1, 1} // Diagonals
+    };
+
+    for (const auto& [dx, dy] : directions) {
+        int nx = x + dx;
+        int ny = y + dy;
+
+        // check if the adjacent cell is within map
+        if (nx >= 0 && nx < static_cast<int>(regionMap.size()) && ny >= 0 && ny < static_cast<int>(regionMap[0].size())) {
+            // if the adjacent cell is powered power line or power line over road, true
+            if ((regionMap[nx][ny].zone == POWERLINE || regionMap[nx][ny].zone == POWERLINE_OVER_ROAD) && regionMap[nx][ny].isPowered) {
+                return true;
+            }
+        }
+    }
+    // no powered power lines next to this cell
+    return false;
+}
+
+// function to look for a powerplant(s) on the map
+void ReferenceEngine::findPowerPlant(std::vector<std::pair<int, int>>& powerPlants) {
+    for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
+        for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
+            if (regionMap[x][y].zone == POWERPLANT) {
+                powerPlants.push_back({x, y});
+            }
+        }
+    }
+}
+
+// function that uses BFS to propogate power throughout region
+void ReferenceEngine::bfsPowerPropagation(int startX, int startY) {
+    std::queue<std::pair<int, int>> q;
+    q.push({startX, startY});
+    regionMap[startX][startY].isPowered = true;
+    // std::cout << "Powering cell (" << startX << ", " << startY << ")\n"; // this is for debugging power
+
+    std::vector<std::pair<int, int>> directions = {
+        {-1, 0}, {1, 0}, {0, -1}, {0, 1},    // Up, Down, Left, Right
+        {-1, -1}, {-1, 1}, {1, -1}, {1, 1}   // Diagonals
+    };
+
+    while (!q.empty()) {
+        auto [x, y] = q.front();
+        q.pop();
+
+        for (auto [dx, dy] : directions) {
+            int nx = x + dx;
+            int ny = y + dy;
+
+            if (nx >= 0 && nx < static_cast<int>(regionMap.size()) && ny >= 0 && ny < static_cast<int>(regionMap[0].size())) {
+                // if cell is power line or power line over road and not powered, mark it and continue BFS
+                if ((regionMap[nx][ny].zone == POWERLINE || regionMap[nx][ny].zone == POWERLINE_OVER_ROAD) && !regionMap[nx][ny].isPowered) {
+                    regionMap[nx][ny].isPowered = true;
+                    q.push({nx, ny});
+                    // std::cout << "Powering cell (" << nx << ", " << ny << ")\n"; // this is also for debugging power
+                }
+            }
+        }
+    }
+}
+
+void ReferenceEngine::markPowered() {
+    for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
+        for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
+            if ((regionMap[x][y].zone == POWERLINE || regionMap[x][y].zone == POWERLINE_OVER_ROAD) && regionMap[x][y].isPowered) {
+
+                std::vector<std::pair<int, int>> directions = {
+                    {-1, 0}, {1, 0}, {0, -1}, {0, 1},    // Up, Down, Left, Right
+                    {-1, -1}, {-1, 1}, {1, -1}, {1, 1}   // Diagonals
+                };
+
+                for (auto [dx, dy] : directions) {
+                    int nx = x + dx;
+                    int ny = y + dy;
+                    if (nx >= 0 && static_cast<size_t>(nx) < regionMap.size() && ny >= 0 && static_cast<size_t>(ny) < regionMap[0].size()) {
+                        if (regionMap[nx][ny].zone != EMPTY) {
+                            regionMap[nx][ny].isPowered = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ReferenceEngine::updatePower() {
+    std::vector<std::pair<int, int>> powerPlants;
+    findPowerPlant(powerPlants);
+
+    // if no power plants, return (nothing will be powered)
+    if (powerPlants.empty()) return;
+
+    // run BFS from each power plant to propagate power through power lines
+    for (auto [x, y] : powerPlants) {
+        bfsPowerPropagation(x, y);
+    }
+
+    // mark cells adjacent to powered power lines as powered
+    markPowered();
+}
+
+//**GROWTH FUNCTIONS**//
+void ReferenceEngine::residentialGrowth() {
+    std::vector<std::tuple<int, int, int>> growthCandidates;  // Store (x, y, priority)
+
+    // First pass: Find all residential cells eligible for growth
+    for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
+        for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
+            Cell& cell = regionMap[x][y];
+            if (cell.zone == RESIDENTIAL) {
+                bool eligibleForGrowth = false;
+                int adjCount = 0;
+
+                // Determine eligibility based on population level and adjacency requirements
+                switch (cell.population) {
+                    case 0:
+                        eligibleForGrowth = hasAdjPower(x, y) || countAdjPop(x, y, 1) > 0;
+                        break;
+                    case 1:
+                        adjCount = countAdjPop(x, y, 1);
+                        eligibleForGrowth = (adjCount >= 2);
+                        break;
+                    case 2:
+                        adjCount = countAdjPop(x, y, 2);
+                        eligibleForGrowth = (adjCount >= 4);
+                        break;
+                    case 3:
+                        adjCount = countAdjPop(x, y, 3);
+                        eligibleForGrowth = (adjCount >= 6);
+                        break;
+                    case 4:
+                        adjCount = countAdjPop(x, y, 4);
+                        eligibleForGrowth = (adjCount >= 8);
+                        break;
+                }
+
+                // If cell is eligible for growth, add it to candidates
+                if (eligibleForGrowth) {
+                    growthCandidates.emplace_back(x, y, cell.population);
+                }
+            }
+        }
+    }
+
+    // Sort candidates based on growth rules: higher population first, then smaller coordinates
+    std::sort(growthCandidates.begin(), growthCandidates.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<2>(b), std::get<1>(a), std::get<0>(a)) < std::tie(std::get<2>(a), std::get<1>(b), std::get<0>(b));
+    });
+
+    // Apply growth to eligible cells
+    for (const auto& [x, y, _] : growthCandidates) {
+        Cell& cell = regionMap[x][y];
+        cell.population++;
+
+        // Generate workers based on new population
+        cell.availableWorkers = cell.population;  // Example: 1 worker per population unit
+    }
+}
+
+void ReferenceEngine::industrialGrowth() {
+    std::vector<std::tuple<int, int, int>> growthCandidates;
+
+    // First pass: Identify all eligible industrial cells for growth
+    for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
+        for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
+            Cell& cell = regionMap[x][y];
+            if (cell.zone == INDUSTRIAL) {
+                bool eligible = false;
+
+                // Determine growth eligibility based on population level
+                switch (cell.population) {
+                    case 0:
+                        eligible = (hasAdjPower(x, y) || countAdjPop(x, y, 1) > 0) &&
+                                   countAvailableWorkers() >= 2;
+                        break;
+                    case 1:
+                        eligible = countAdjPop(x, y, 1) >= 2 && countAvailableWorkers() >= 2;
+                        break;
+                    case 2:
+                        eligible = countAdjPop(x, y, 2) >= 4 && countAvailableWorkers() >= 2;
+                        break;
+                }
+
+                // Add eligible cells to growth candidates
+                if (eligible) {
+                    growthCandidates.emplace_back(x, y, cell.population);
+                }
+            }
+        }
+    }
+
+    // Sort candidates by growth priority: larger population first, then adjacency count
+    std::sort(growthCandidates.begin(), growthCandidates.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<2>(b), std::get<1>(a), std::get<0>(a)) <
+               std::tie(std::get<2>(a), std::get<1>(b), std::get<0>(b));
+    });
+
+    // Second pass: Apply growth to the eligible cells
+    for (const auto& [x, y, _] : growthCandidates) {
+        Cell& cell = regionMap[x][y];
+        if (countAvailableWorkers() >= 2) { // Ensure enough workers are available
+            cell.population++; // Increment population
+            assignWorkerToJob(); // Deduct 2 workers
+            cell.availableGoods += cell.population; // Produce goods
+        }
+    }
+}
+
+void ReferenceEngine::commercialGrowth() {
+    std::vector<std::tuple<int, int, int>> growthCandidates;
+
+    for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
+        for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
+            Cell& cell = regionMap[x][y];
+            if (cell.zone == COMMERCIAL) {
+                bool eligible = false;
+
+                switch (cell.population) {
+                    case 0:
+                        eligible = hasAdjPower(x, y) && countAvailableWorkers() >= 1 && countAvailableGoods() >= 1;
+                        break;
+                    case 1:
+                        eligible = countAdjPop(x, y, 1) >= 2 && countAvailableWorkers() >= 1 && countAvailableGoods() >= 1;
+                        break;
+                    case 2:
+                        eligible = countAdjPop(x, y, 2) >= 4 && countAvailableWorkers() >= 1 && countAvailableGoods() >= 1;
+                        break;
+                }
+
+                if (eligible) {
+                    growthCandidates.emplace_back(x, y, cell.population);
+                }
+            }
+        }
+    }
+
+    // Sort and grow Commercial zones
+    std::sort(growthCandidates.begin(), growthCandidates.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<2>(b), std::get<1>(a), std::get<0>(a)) <
+               std::tie(std::get<2>(a), std::get<1>(b), std::get<0>(b));
+    });
+
+    for (const auto& [x, y, _] : growthCandidates) {
+        Cell& cell = regionMap[x][y];
+        cell.population++;
+        assignWorkerToJob();  // Deduct 1 worker
+        assignGoodToCell();   // Deduct 1 good
+    }
+}
+
+void ReferenceEngine::spreadPollution() {
+    std::queue<std::tuple<int, int, int>> pollutionQueue;
+
+    // Initialize the queue with all industrial cells
+    for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
+        for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
+            Cell& cell = regionMap[x][y];
+
+            if (cell.zone == INDUSTRIAL && cell.population > 0) {
+                pollutionQueue.emplace(x, y, cell.population); // (x, y, pollution level)
+            }
+        }
+    }
+
+    // Directions for adjacency (including diagonals)
+    std::vector<std::pair<int, int>> directions = {
+        {-1, 0}, {1, 0}, {0, -1}, {0, 1},    // Up, Down, Left, Right
+        {-1, -1}, {-1, 1}, {1, -1}, {1, 1}  // Diagonals
+    };
+
+    // BFS to spread pollution
+    while (!pollutionQueue.empty()) {
+        auto [x, y, pollutionLevel] = pollutionQueue.front();
+        pollutionQueue.pop();
+
+        for (const auto& [dx, dy] : directions) {
+            int nx = x + dx;
+            int ny = y + dy;
+
+            // Check bounds
+            if (nx >= 0 && nx < static_cast<int>(regionMap.size()) &&
+                ny >= 0 && ny < static_cast<int>(regionMap[0].size())) {
+                Cell& adjacentCell = regionMap[nx][ny];
+
+                // Spread pollution if decayed value is greater than current pollution
+                int decayedPollution = pollutionLevel - 1;
+                if (decayedPollution > 0 && adjacentCell.pollution < decayedPollution) {
+                    adjacentCell.pollution = decayedPollution;
+                    pollutionQueue.emplace(nx, ny, decayedPollution); // Continue spreading
+                }
+            }
+        }
+    }
+}
+
+void ReferenceEngine::assignGoodToCell() {
+    for (auto& row : regionMap) {
+        for (auto& cell : row) {
+            if (cell.zone == INDUSTRIAL && cell.availableGoods > 0) {
+                cell.availableGoods--; // Deduct 1 good
+                return;
+            }
+        }
+    }
+}
+
+int ReferenceEngine::countAvailableGoods() const {
+    int totalGoods = 0;
+    for (const auto& row : regionMap) {
+        for (const auto& cell : row) {
+            if (cell.zone == INDUSTRIAL) {
+                totalGoods += cell.availableGoods;
+            }
+        }
+    }
+    return totalGoods;
+}
+
+int ReferenceEngine::countAvailableWorkers() const {
+    int totalWorkers = 0;
+    for (const auto& row : regionMap) {
+        for (const auto& cell : row) {
+            totalWorkers += cell.availableWorkers;
+        }
+    }
+    return totalWorkers;
+}
+
+void ReferenceEngine::assignWorkerToJob() {
+    for (auto& row : regionMap) {
+        for (auto& cell : row) {
+            if (cell.zone == RESIDENTIAL && cell.availableWorkers >= 2) {
+                cell.availableWorkers -= 2;  // Deduct 2 workers for industrial jobs
+                return;
+            }
+        }
+    }
+}
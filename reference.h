@@ -0,0 +1,41 @@
+#ifndef REFERENCE_H
+#define REFERENCE_H
+
+#include<vector>
+
+#include "simulation.h"
+
+// Frozen copy of the original tick rules (power, growth, pollution) with
+// scan-order matching. Used only as ground truth by the verification mode;
+// optimizations belong in Simulation, never here.
+class ReferenceEngine{
+private:
+    std::vector<std::vector<Cell>> regionMap;
+
+    int countAdjPop(int x, int y, int minPopulation) const;
+
+    // functions for power
+    void findPowerPlant(std::vector<std::pair<int, int>>& powerPlants);
+    void bfsPowerPropagation(int startX, int startY);
+    void markPowered();
+    bool hasAdjPower(int x, int y) const;
+
+    // Resource management
+    int countAvailableWorkers() const;
+    void assignWorkerToJob();
+    int countAvailableGoods() const;
+    void assignGoodToCell();
+
+public:
+    ReferenceEngine(const std::vector<std::vector<Cell>>& layout);
+    const std::vector<std::vector<Cell>>& getMap() const;
+
+    // tick phases, in the order Simulation::simulate() runs them
+    void updatePower();
+    void residentialGrowth();
+    void industrialGrowth();
+    void commercialGrowth();
+    void spreadPollution();
+};
+
+#endif
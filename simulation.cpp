@@ -1,4 +1,6 @@
 #include "simulation.h"
+#include "history.h"
+#include "overview.h"
 
 #include <iostream>
 #include <fstream>
@@ -8,7 +10,72 @@
 #include <algorithm>
 #include <cctype>
 #include <locale>
-#include <queue>
+#include <atomic>
+#include <climits>
+
+// neighbour offsets shared by the power and pollution passes
+static constexpr std::pair<int, int> directions[] = {
+    {-1, 0}, {1, 0}, {0, -1}, {0, 1},    // Up, Down, Left, Right
+    {-1, -1}, {-1, 1}, {1, -1}, {1, 1}   // Diagonals
+};
+
+/*********************************
+REGION MAP
+*********************************/
+
+// unique id for every map, so a row's owner is never mistaken for another map
+static std::atomic<unsigned long> nextRegionMapId{1};
+
+RegionMap::RegionMap() : id(nextRegionMapId++) {}
+
+RegionMap RegionMap::fork() {
+    RegionMap branch;
+    branch.rows = rows;
+
+    // this map gives up in-place writes too, since its rows are now shared
+    id = nextRegionMapId++;
+    return branch;
+}
+
+void RegionMap::push_back(const std::vector<Cell>& row) {
+    rows.push_back(std::make_shared<Row>(Row{row, id}));
+}
+
+void RegionMap::assign(const std::vector<std::vector<Cell>>& grid) {
+    rows.clear();
+    for (const auto& row : grid) {
+        push_back(row);
+    }
+}
+
+// writable cell; copies the row first if it may be shared with another map
+Cell& RegionMap::edit(size_t x, size_t y) {
+    if (rows[x]->owner != id) {
+        rows[x] = std::make_shared<Row>(Row{rows[x]->cells, id});
+    }
+    if (trackingEdits) {
+        int cell = x * rows[0]->cells.size() + y;
+        if (!edited[cell]) {
+            edited[cell] = true;
+            editedCells.push_back(cell);
+        }
+    }
+    return rows[x]->cells[y];
+}
+
+void RegionMap::trackEdits() {
+    size_t cells = rows.empty() ? 0 : rows.size() * rows[0]->cells.size();
+    trackingEdits = true;
+    edited.assign(cells, false);
+    editedCells.reserve(cells);  // each cell is logged at most once, so this never grows
+}
+
+void RegionMap::clearEdits() {
+    for (int cell : editedCells) {
+        edited[cell] = false;
+    }
+    editedCells.clear();
+}
 
 //constructor
 Simulation::Simulation() {
@@ -16,9 +83,16 @@ Simulation::Simulation() {
     config.RegionLayout = "";
     config.timeLimit = 0;
     config.refreshRate = 0;
+    config.nearestMatching = false;
+    config.historyFile = "";
+    config.keyframeInterval = 10;
+    config.overviewZoom = 0;
 
 }
 
+// destructor, defined here where RunHistory and OverviewRenderer are complete
+Simulation::~Simulation() = default;
+
 /*********************************
 PROTECTED MEMBERS
 *********************************/
@@ -38,6 +112,25 @@ void Simulation::initializeSim(const std::string& configFilePath) {
         throw std::runtime_error("Failed to read the region layout file.");
     }
 
+    // size the per-tick buffers now that the map dimensions are known
+    reserveScratch();
+
+    // open the run history next to the config and store the initial map as tick 0
+    if (!config.historyFile.empty()) {
+        std::filesystem::path historyPath = configPath.parent_path() / config.historyFile;
+        history = std::make_unique<RunHistory>(historyPath.string(), regionMap.size(),
+                                               regionMap.empty() ? 0 : regionMap[0].size(),
+                                               config.keyframeInterval);
+        history->reserve(config.timeLimit + 1);
+        history->record(regionMap);
+    }
+
+    // build the overview pyramid once; later ticks only push edited cells up
+    if (config.overviewZoom > 0) {
+        overview = std::make_unique<OverviewRenderer>(regionMap);
+        regionMap.trackEdits();
+    }
+
     // print
     printConfig();
     std::cout << "\nContents of " << config.RegionLayout << ": " << std::endl;
@@ -106,6 +199,26 @@ bool Simulation::readRegion(const std::string& path) {
     return true; //true if successfull
 }
 
+// reserve scratch buffers for the worst case of a tick on this map
+void Simulation::reserveScratch() {
+    size_t cells = regionMap.empty() ? 0 : regionMap.size() * regionMap[0].size();
+    powerPlants.reserve(cells);
+    powerQueue.reserve(cells);      // each cell is queued at most once per BFS
+    // every industrial cell, plus one entry per rise in a cell's pollution; spread
+    // pollution is at most 2 (industry caps at 3), so a cell rises at most twice a pass
+    pollutionQueue.reserve(3 * cells);
+    growthCandidates.reserve(cells);
+
+    // nearest matching: label every cell up front and size the repair buffers
+    if (config.nearestMatching) {
+        roadQueue.reserve(cells);
+        roadSeeds.reserve(cells);
+        resetCells.reserve(cells);
+        buildSupplierIndex(workerSuppliers);
+        buildSupplierIndex(goodsSuppliers);
+    }
+}
+
 //read setting from config file
 bool Simulation::readConfig(const std::string& path) {
     std::ifstream file(path);
@@ -128,6 +241,14 @@ bool Simulation::readConfig(const std::string& path) {
             config.timeLimit = std::stoi(value); 
         } else if (key == "Refresh Rate") {
             config.refreshRate = std::stoi(value); //set refreshrate
+        } else if (key == "Matching Mode") { //"nearest" matches supply by road distance
+            config.nearestMatching = (value == "nearest");
+        } else if (key == "History File") { //file to record the run history into
+            config.historyFile = value;
+        } else if (key == "Keyframe Interval") { //ticks between full history snapshots
+            config.keyframeInterval = std::stoi(value);
+        } else if (key == "Overview Zoom") { //print a downsampled map instead of every cell
+            config.overviewZoom = std::stoi(value);
         }
     }
 
@@ -144,9 +265,26 @@ void Simulation::printConfig() const {
     std::cout << "- Region Layout File: " << config.RegionLayout << std::endl;
     std::cout << "- Time Limit: " << config.timeLimit << std::endl;
     std::cout << "- Refresh Rate: " << config.refreshRate << std::endl;
+    if (config.nearestMatching) {
+        std::cout << "- Matching Mode: nearest" << std::endl;
+    }
+    if (!config.historyFile.empty()) {
+        std::cout << "- History File: " << config.historyFile
+                  << " (keyframe every " << config.keyframeInterval << " ticks)" << std::endl;
+    }
+    if (config.overviewZoom > 0) {
+        std::cout << "- Overview Zoom: " << config.overviewZoom << std::endl;
+    }
 }
 
 void Simulation::printMap() const {
+    // large maps: draw the top-left of the overview at the configured zoom
+    if (config.overviewZoom > 0) {
+        const int overviewRows = 40, overviewCols = 20;
+        printOverview(config.overviewZoom, 0, 0, overviewRows, overviewCols);
+        return;
+    }
+
     int width = regionMap.empty() ? 0 : regionMap[0].size();
 
     // Define cell width for consistent formatting
@@ -208,6 +346,17 @@ void Simulation::printMap() const {
     std::cout << "==" << std::string(width * cellWidth, '=') << "==" << std::endl;
 }
 
+// print a window of the overview map; with a pyramid the cost depends on the
+// window, not the map. Forks keep no pyramid (it is larger than the map rows
+// they share), so printing one builds a temporary pyramid in O(map).
+void Simulation::printOverview(int zoom, int top, int left, int height, int width) const {
+    if (overview) {
+        overview->render(std::cout, zoom, top, left, height, width);
+    } else {
+        OverviewRenderer(regionMap).render(std::cout, zoom, top, left, height, width);
+    }
+}
+
 void Simulation::printResults() const {
     Stats simStats;
 
@@ -256,11 +405,6 @@ int Simulation::countAdjPop(int x, int y, int minPopulation) const {
 
 // helper function to check if a cell is adjacent to a power line
 bool Simulation::hasAdjPower(int x, int y) const {
-    std::vector<std::pair<int, int>> directions = {
-        {-1, 0}, {1, 0}, {0, -1}, {0, 1},  // Up, Down, Left, Right
-        {-1, -1}, {-1, 1}, {1, -1}, {1, 1} // Diagonals
-    };
-
     for (const auto& [dx, dy] : directions) {
         int nx = x + dx;
         int ny = y + dy;
@@ -278,7 +422,8 @@ bool Simulation::hasAdjPower(int x, int y) const {
 }
 
 // function to look for a powerplant(s) on the map
-void Simulation::findPowerPlant(std::vector<std::pair<int, int>>& powerPlants) {
+void Simulation::findPowerPlant() {
+    powerPlants.clear();
     for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
         for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
             if (regionMap[x][y].zone == POWERPLANT) {
@@ -290,19 +435,16 @@ void Simulation::findPowerPlant(std::vector<std::pair<int, int>>& powerPlants) {
 
 // function that uses BFS to propogate power throughout region
 void Simulation::bfsPowerPropagation(int startX, int startY) {
-    std::queue<std::pair<int, int>> q;
-    q.push({startX, startY});
-    regionMap[startX][startY].isPowered = true;
+    // powerQueue is used as a FIFO: head walks forward instead of popping
+    powerQueue.clear();
+    powerQueue.push_back({startX, startY});
+    if (!regionMap[startX][startY].isPowered) {
+        regionMap.edit(startX, startY).isPowered = true;
+    }
     // std::cout << "Powering cell (" << startX << ", " << startY << ")\n"; // this is for debugging power
 
-    std::vector<std::pair<int, int>> directions = {
-        {-1, 0}, {1, 0}, {0, -1}, {0, 1},    // Up, Down, Left, Right
-        {-1, -1}, {-1, 1}, {1, -1}, {1, 1}   // Diagonals
-    };
-
-    while (!q.empty()) {
-        auto [x, y] = q.front();
-        q.pop();
+    for (size_t head = 0; head < powerQueue.size(); head++) {
+        auto [x, y] = powerQueue[head];
 
         for (auto [dx, dy] : directions) {
             int nx = x + dx;
@@ -311,8 +453,8 @@ void Simulation::bfsPowerPropagation(int startX, int startY) {
             if (nx >= 0 && nx < static_cast<int>(regionMap.size()) && ny >= 0 && ny < static_cast<int>(regionMap[0].size())) {
                 // if cell is power line or power line over road and not powered, mark it and continue BFS
                 if ((regionMap[nx][ny].zone == POWERLINE || regionMap[nx][ny].zone == POWERLINE_OVER_ROAD) && !regionMap[nx][ny].isPowered) {
-                    regionMap[nx][ny].isPowered = true;
-                    q.push({nx, ny});
+                    regionMap.edit(nx, ny).isPowered = true;
+                    powerQueue.push_back({nx, ny});
                     // std::cout << "Powering cell (" << nx << ", " << ny << ")\n"; // this is also for debugging power
                 }
             }
@@ -324,18 +466,13 @@ void Simulation::markPowered() {
     for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
         for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
             if ((regionMap[x][y].zone == POWERLINE || regionMap[x][y].zone == POWERLINE_OVER_ROAD) && regionMap[x][y].isPowered) {
-
-                std::vector<std::pair<int, int>> directions = {
-                    {-1, 0}, {1, 0}, {0, -1}, {0, 1},    // Up, Down, Left, Right
-                    {-1, -1}, {-1, 1}, {1, -1}, {1, 1}   // Diagonals
-                };
-
                 for (auto [dx, dy] : directions) {
                     int nx = x + dx;
                     int ny = y + dy;
                     if (nx >= 0 && static_cast<size_t>(nx) < regionMap.size() && ny >= 0 && static_cast<size_t>(ny) < regionMap[0].size()) {
-                        if (regionMap[nx][ny].zone != EMPTY) {
-                            regionMap[nx][ny].isPowered = true;
+                        // only write cells that change so shared rows are not copied needlessly
+                        if (regionMap[nx][ny].zone != EMPTY && !regionMap[nx][ny].isPowered) {
+                            regionMap.edit(nx, ny).isPowered = true;
                         }
                     }
                 }
@@ -345,8 +482,7 @@ void Simulation::markPowered() {
 }
 
 void Simulation::updatePower() {
-    std::vector<std::pair<int, int>> powerPlants;
-    findPowerPlant(powerPlants);
+    findPowerPlant();
 
     // if no power plants, return (nothing will be powered)
     if (powerPlants.empty()) return;
@@ -362,61 +498,112 @@ void Simulation::updatePower() {
 
 //**SIMULATION HANDLING**//
 void Simulation::simulate() {
-    int currentTimeStep = 0;
     bool hasChanges = true;
 
-    while (currentTimeStep < config.timeLimit && hasChanges) {
+    // continues from the current tick, so a fork picks up where it branched
+    while (currentTick < config.timeLimit && hasChanges) {
+        int currentTimeStep = currentTick;
         std::cout << "Timestep " << currentTimeStep + 1 << ":\n";
 
-        hasChanges = false;
-
-        updatePower();          // Step 1: Update power propagation
-        residentialGrowth();    // Step 2: Generate workers
-        industrialGrowth();     // Step 3: Generate goods and pollution
-        commercialGrowth();     // Step 4: Consume goods and workers
-        spreadPollution();      // Step 5: Spread pollution from Industrial zones
-
-        hasChanges = detectChanges(); // Step 6: Detect changes
+        hasChanges = step();
 
         if (currentTimeStep % config.refreshRate == 0 || !hasChanges) {
             printResults();
         }
-
-        currentTimeStep++;
     }
 
     std::cout << "Simulation complete.\nFinal state:\n";
     printResults();
 }
 
-// Helper function to detect changes in the map 
-bool Simulation::detectChanges() {
-    static std::vector<std::vector<int>> previousPopulation(regionMap.size(),
-                                                            std::vector<int>(regionMap[0].size(), 0));
-    bool hasChanged = false;
+bool Simulation::step() {
+    updatePower();          // Step 1: Update power propagation
+    residentialGrowth();    // Step 2: Generate workers
+    industrialGrowth();     // Step 3: Generate goods and pollution
+    commercialGrowth();     // Step 4: Consume goods and workers
+    spreadPollution();      // Step 5: Spread pollution from Industrial zones
 
-    for (size_t x = 0; x < regionMap.size(); x++) {
-        for (size_t y = 0; y < regionMap[x].size(); y++) {
-            // Check if population, goods, or pollution has changed
-            const Cell& cell = regionMap[x][y];
-            if (cell.population != previousPopulation[x][y]) {
-                hasChanged = true;
-                previousPopulation[x][y] = cell.population;
-            }
+    bool hasChanges = detectChanges(); // Step 6: Detect changes
+
+    if (history) {
+        history->record(regionMap); // Step 7: Append this tick to the run history
+    }
+    if (overview) {
+        // Step 8: Push the cells edited this tick up the overview pyramid
+        int width = regionMap[0].size();
+        for (int cell : regionMap.getEditedCells()) {
+            overview->update(cell / width, cell % width, regionMap[cell / width][cell % width]);
         }
+        regionMap.clearEdits();
+    }
+
+    currentTick++;
+    return hasChanges;
+}
+
+int Simulation::getCurrentTick() const {
+    return currentTick;
+}
+
+std::unique_ptr<Simulation> Simulation::fork() {
+    auto branch = std::make_unique<Simulation>();
+    branch->config = config;
+    branch->config.historyFile = "";  // branches never append to the parent's history
+    branch->regionMap = regionMap.fork();  // copies row pointers only
+    branch->currentTick = currentTick;
+
+    // scratch buffers, supplier caches and the overview are left empty and
+    // grow on first use, so an idle branch costs little more than its row table
+    return branch;
+}
+
+void Simulation::setZone(int x, int y, ZoneType zone) {
+    if (x < 0 || x >= static_cast<int>(regionMap.size()) || y < 0 || y >= static_cast<int>(regionMap[0].size())) {
+        throw std::out_of_range("Cell (" + std::to_string(x) + ", " + std::to_string(y) + ") is outside the region.");
+    }
+
+    // pollution stays with the land; everything else starts fresh
+    Cell& cell = regionMap.edit(x, y);
+    if (cell.population != 0) {
+        populationChanged = true;  // the next detectChanges() must see the lost population
+    }
+    Cell rezoned;
+    rezoned.zone = zone;
+    rezoned.pollution = cell.pollution;
+    cell = rezoned;
+
+    // road distances and overview tiles depend on the zone layout
+    supplyChanged(x, y, true);
+    if (overview) {
+        overview->update(x, y, cell);
     }
+}
+
+RunHistory* Simulation::getHistory() const {
+    return history.get();
+}
+
+const RegionMap& Simulation::getMap() const {
+    return regionMap;
+}
 
+// Helper function to detect changes in the map 
+// population only changes when a growth rule grows a cell, so the rules flag
+// it as they go instead of keeping a copy of every cell's population
+bool Simulation::detectChanges() {
+    bool hasChanged = populationChanged;
+    populationChanged = false;
     return hasChanged;
 }
 
 //**GROWTH FUNCTIONS**//
 void Simulation::residentialGrowth() {
-    std::vector<std::tuple<int, int, int>> growthCandidates;  // Store (x, y, priority)
+    growthCandidates.clear();  // Store (x, y, priority)
 
     // First pass: Find all residential cells eligible for growth
     for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
         for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
-            Cell& cell = regionMap[x][y];
+            const Cell& cell = regionMap[x][y];
             if (cell.zone == RESIDENTIAL) {
                 bool eligibleForGrowth = false;
                 int adjCount = 0;
@@ -459,21 +646,23 @@ void Simulation::residentialGrowth() {
 
     // Apply growth to eligible cells
     for (const auto& [x, y, _] : growthCandidates) {
-        Cell& cell = regionMap[x][y];
+        Cell& cell = regionMap.edit(x, y);
         cell.population++;
+        populationChanged = true;
 
         // Generate workers based on new population
         cell.availableWorkers = cell.population;  // Example: 1 worker per population unit
+        supplyChanged(x, y);
     }
 }
 
 void Simulation::industrialGrowth() {
-    std::vector<std::tuple<int, int, int>> growthCandidates;
+    growthCandidates.clear();
 
     // First pass: Identify all eligible industrial cells for growth
     for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
         for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
-            Cell& cell = regionMap[x][y];
+            const Cell& cell = regionMap[x][y];
             if (cell.zone == INDUSTRIAL) {
                 bool eligible = false;
 
@@ -507,21 +696,23 @@ void Simulation::industrialGrowth() {
 
     // Second pass: Apply growth to the eligible cells
     for (const auto& [x, y, _] : growthCandidates) {
-        Cell& cell = regionMap[x][y];
         if (countAvailableWorkers() >= 2) { // Ensure enough workers are available
+            Cell& cell = regionMap.edit(x, y);
             cell.population++; // Increment population
-            assignWorkerToJob(); // Deduct 2 workers
+            populationChanged = true;
+            assignWorkerToJob(x, y); // Deduct 2 workers
             cell.availableGoods += cell.population; // Produce goods
+            supplyChanged(x, y);
         }
     }
 }
 
 void Simulation::commercialGrowth() {
-    std::vector<std::tuple<int, int, int>> growthCandidates;
+    growthCandidates.clear();
 
     for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
         for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
-            Cell& cell = regionMap[x][y];
+            const Cell& cell = regionMap[x][y];
             if (cell.zone == COMMERCIAL) {
                 bool eligible = false;
 
@@ -551,37 +742,30 @@ void Simulation::commercialGrowth() {
     });
 
     for (const auto& [x, y, _] : growthCandidates) {
-        Cell& cell = regionMap[x][y];
-        cell.population++;
-        assignWorkerToJob();  // Deduct 1 worker
-        assignGoodToCell();   // Deduct 1 good
+        regionMap.edit(x, y).population++;
+        populationChanged = true;
+        assignWorkerToJob(x, y);  // Deduct 1 worker
+        assignGoodToCell(x, y);   // Deduct 1 good
     }
 }
 
 void Simulation::spreadPollution() {
-    std::queue<std::tuple<int, int, int>> pollutionQueue;
+    pollutionQueue.clear();
 
     // Initialize the queue with all industrial cells
     for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
         for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
-            Cell& cell = regionMap[x][y];
+            const Cell& cell = regionMap[x][y];
 
             if (cell.zone == INDUSTRIAL && cell.population > 0) {
-                pollutionQueue.emplace(x, y, cell.population); // (x, y, pollution level)
+                pollutionQueue.emplace_back(x, y, cell.population); // (x, y, pollution level)
             }
         }
     }
 
-    // Directions for adjacency (including diagonals)
-    std::vector<std::pair<int, int>> directions = {
-        {-1, 0}, {1, 0}, {0, -1}, {0, 1},    // Up, Down, Left, Right
-        {-1, -1}, {-1, 1}, {1, -1}, {1, 1}  // Diagonals
-    };
-
-    // BFS to spread pollution
-    while (!pollutionQueue.empty()) {
-        auto [x, y, pollutionLevel] = pollutionQueue.front();
-        pollutionQueue.pop();
+    // BFS to spread pollution (head index walks the queue in FIFO order)
+    for (size_t head = 0; head < pollutionQueue.size(); head++) {
+        auto [x, y, pollutionLevel] = pollutionQueue[head];
 
         for (const auto& [dx, dy] : directions) {
             int nx = x + dx;
@@ -590,13 +774,13 @@ void Simulation::spreadPollution() {
             // Check bounds
             if (nx >= 0 && nx < static_cast<int>(regionMap.size()) &&
                 ny >= 0 && ny < static_cast<int>(regionMap[0].size())) {
-                Cell& adjacentCell = regionMap[nx][ny];
+                const Cell& adjacentCell = regionMap[nx][ny];
 
                 // Spread pollution if decayed value is greater than current pollution
                 int decayedPollution = pollutionLevel - 1;
                 if (decayedPollution > 0 && adjacentCell.pollution < decayedPollution) {
-                    adjacentCell.pollution = decayedPollution;
-                    pollutionQueue.emplace(nx, ny, decayedPollution); // Continue spreading
+                    regionMap.edit(nx, ny).pollution = decayedPollution;
+                    pollutionQueue.emplace_back(nx, ny, decayedPollution); // Continue spreading
                 }
             }
         }
@@ -606,21 +790,37 @@ void Simulation::spreadPollution() {
 void Simulation::produceGoods() {
     for (int x = 0; x < static_cast<int>(regionMap.size()); x++) {
         for (int y = 0; y < static_cast<int>(regionMap[0].size()); y++) {
-            Cell& cell = regionMap[x][y];
+            const Cell& cell = regionMap[x][y];
 
             if (cell.zone == INDUSTRIAL && cell.population > 0) {
                 // Produce goods based on population
-                cell.availableGoods += cell.population;
+                Cell& producer = regionMap.edit(x, y);
+                producer.availableGoods += producer.population;
+                supplyChanged(x, y);
             }
         }
     }
 }
 
-void Simulation::assignGoodToCell() {
-    for (auto& row : regionMap) {
-        for (auto& cell : row) {
+void Simulation::assignGoodToCell(int x, int y) {
+    // nearest mode: take from the closest industrial cell by road that has goods
+    if (config.nearestMatching) {
+        int width = regionMap[0].size();
+        int nearest = nearestSupplier(goodsSuppliers, x, y);
+        if (nearest >= 0) {
+            regionMap.edit(nearest / width, nearest % width).availableGoods--; // Deduct 1 good
+            supplyChanged(nearest / width, nearest % width);
+            return;
+        }
+    }
+
+    // otherwise (or if nothing reachable has goods) take from the first in scan order
+    for (size_t sx = 0; sx < regionMap.size(); sx++) {
+        for (size_t sy = 0; sy < regionMap[sx].size(); sy++) {
+            const Cell& cell = regionMap[sx][sy];
             if (cell.zone == INDUSTRIAL && cell.availableGoods > 0) {
-                cell.availableGoods--; // Deduct 1 good
+                regionMap.edit(sx, sy).availableGoods--; // Deduct 1 good
+                supplyChanged(sx, sy);
                 return;
             }
         }
@@ -649,13 +849,191 @@ int Simulation::countAvailableWorkers() const {
     return totalWorkers;
 }
 
-void Simulation::assignWorkerToJob() {
-    for (auto& row : regionMap) {
-        for (auto& cell : row) {
+void Simulation::assignWorkerToJob(int x, int y) {
+    // nearest mode: take from the closest residential cell by road that has workers
+    if (config.nearestMatching) {
+        int width = regionMap[0].size();
+        int nearest = nearestSupplier(workerSuppliers, x, y);
+        if (nearest >= 0) {
+            regionMap.edit(nearest / width, nearest % width).availableWorkers -= 2;  // Deduct 2 workers for industrial jobs
+            supplyChanged(nearest / width, nearest % width);
+            return;
+        }
+    }
+
+    // otherwise (or if nothing reachable has workers) take from the first in scan order
+    for (size_t sx = 0; sx < regionMap.size(); sx++) {
+        for (size_t sy = 0; sy < regionMap[sx].size(); sy++) {
+            const Cell& cell = regionMap[sx][sy];
             if (cell.zone == RESIDENTIAL && cell.availableWorkers >= 2) {
-                cell.availableWorkers -= 2;  // Deduct 2 workers for industrial jobs
+                regionMap.edit(sx, sy).availableWorkers -= 2;  // Deduct 2 workers for industrial jobs
+                supplyChanged(sx, sy);
                 return;
             }
         }
     }
 }
+
+//**SUPPLY MATCHING**//
+// supplier of this index's zone that still has something to hand out
+bool Simulation::isLiveSupplier(const SupplierIndex& index, int x, int y) const {
+    const Cell& cell = regionMap[x][y];
+    if (cell.zone != index.supplierZone) return false;
+    return index.supplierZone == RESIDENTIAL ? cell.availableWorkers >= 2 : cell.availableGoods > 0;
+}
+
+// cells a BFS path may pass through: roads, and the live suppliers it starts from
+bool Simulation::carriesSupply(const SupplierIndex& index, int cell) const {
+    int width = regionMap[0].size();
+    ZoneType zone = regionMap[cell / width][cell % width].zone;
+    return index.live[cell] || zone == ROAD || zone == POWERLINE_OVER_ROAD;
+}
+
+// label every cell with its nearest live supplier (multi-source BFS from all of them)
+void Simulation::buildSupplierIndex(SupplierIndex& index) {
+    int height = regionMap.size();
+    int width = regionMap[0].size();
+    size_t cells = static_cast<size_t>(height) * width;
+
+    index.supplier.assign(cells, -1);
+    index.distance.assign(cells, INT_MAX);
+    index.parent.assign(cells, -1);
+    index.live.assign(cells, false);
+
+    roadSeeds.clear();
+    roadQueue.clear();
+    for (int x = 0; x < height; x++) {
+        for (int y = 0; y < width; y++) {
+            if (isLiveSupplier(index, x, y)) {
+                int cell = x * width + y;
+                index.live[cell] = true;
+                index.supplier[cell] = cell;
+                index.distance[cell] = 0;
+                roadSeeds.push_back(cell);
+            }
+        }
+    }
+    relaxSupplierIndex(index);
+}
+
+// BFS outward from roadSeeds (sorted by distance), improving any cell it reaches
+// with a shorter path; roads and live suppliers carry the search further
+void Simulation::relaxSupplierIndex(SupplierIndex& index) {
+    int height = regionMap.size();
+    int width = regionMap[0].size();
+
+    // take whichever of the next seed and the next queued cell is closer
+    size_t seed = 0;
+    size_t head = 0;
+    roadQueue.clear();
+    while (seed < roadSeeds.size() || head < roadQueue.size()) {
+        int current;
+        if (head >= roadQueue.size() ||
+            (seed < roadSeeds.size() && index.distance[roadSeeds[seed]] <= index.distance[roadQueue[head]])) {
+            current = roadSeeds[seed++];
+        } else {
+            current = roadQueue[head++];
+        }
+
+        int cx = current / width;
+        int cy = current % width;
+        int nextDistance = index.distance[current] + 1;
+
+        for (auto [dx, dy] : directions) {
+            int nx = cx + dx;
+            int ny = cy + dy;
+            if (nx < 0 || nx >= height || ny < 0 || ny >= width) continue;
+
+            int next = nx * width + ny;
+            if (index.distance[next] > nextDistance) {
+                index.distance[next] = nextDistance;
+                index.supplier[next] = index.supplier[current];
+                index.parent[next] = current;
+                if (carriesSupply(index, next)) {
+                    roadQueue.push_back(next);
+                }
+            }
+        }
+    }
+}
+
+// cell's zone or supply changed: drop every label that was reached through it,
+// then re-run the BFS from the labelled cells bordering that region
+void Simulation::repairSupplierIndex(SupplierIndex& index, int cell) {
+    int height = regionMap.size();
+    int width = regionMap[0].size();
+    index.live[cell] = isLiveSupplier(index, cell / width, cell % width);
+
+    // collect the subtree of the BFS forest below cell (children are always neighbours)
+    resetCells.clear();
+    resetCells.push_back(cell);
+    index.supplier[cell] = -1;
+    index.distance[cell] = INT_MAX;
+    index.parent[cell] = -1;
+    for (size_t i = 0; i < resetCells.size(); i++) {
+        int cx = resetCells[i] / width;
+        int cy = resetCells[i] % width;
+        for (auto [dx, dy] : directions) {
+            int nx = cx + dx;
+            int ny = cy + dy;
+            if (nx < 0 || nx >= height || ny < 0 || ny >= width) continue;
+
+            int next = nx * width + ny;
+            if (index.parent[next] == resetCells[i]) {
+                index.supplier[next] = -1;
+                index.distance[next] = INT_MAX;
+                index.parent[next] = -1;
+                resetCells.push_back(next);
+            }
+        }
+    }
+
+    // restart from the cell itself if it is now a supplier, and from the labelled border
+    roadSeeds.clear();
+    if (index.live[cell]) {
+        index.supplier[cell] = cell;
+        index.distance[cell] = 0;
+        roadSeeds.push_back(cell);
+    }
+    for (int reset : resetCells) {
+        int cx = reset / width;
+        int cy = reset % width;
+        for (auto [dx, dy] : directions) {
+            int nx = cx + dx;
+            int ny = cy + dy;
+            if (nx < 0 || nx >= height || ny < 0 || ny >= width) continue;
+
+            int next = nx * width + ny;
+            if (index.distance[next] != INT_MAX && carriesSupply(index, next)) {
+                roadSeeds.push_back(next);
+            }
+        }
+    }
+    std::sort(roadSeeds.begin(), roadSeeds.end(), [&index](int a, int b) {
+        return index.distance[a] < index.distance[b];
+    });
+
+    relaxSupplierIndex(index);
+}
+
+// closest live supplier to (x, y) along roads, or -1 if none is reachable
+int Simulation::nearestSupplier(SupplierIndex& index, int x, int y) {
+    // forks build their index on first use rather than when they branch
+    if (index.supplier.empty()) {
+        buildSupplierIndex(index);
+    }
+    return index.supplier[x * regionMap[0].size() + y];
+}
+
+// keep the supplier indexes in step with a cell whose supply (or zone) changed
+void Simulation::supplyChanged(int x, int y, bool zoneChanged) {
+    if (!config.nearestMatching) return;
+
+    int cell = x * regionMap[0].size() + y;
+    for (SupplierIndex* index : {&workerSuppliers, &goodsSuppliers}) {
+        if (index->supplier.empty()) continue;  // not built yet, nothing to repair
+        if (zoneChanged || index->live[cell] != isLiveSupplier(*index, x, y)) {
+            repairSupplierIndex(*index, cell);
+        }
+    }
+}
@@ -3,6 +3,8 @@
 
 #include<string>
 #include<vector>
+#include<tuple>
+#include<memory>
 
 enum ZoneType {
     RESIDENTIAL = 'R',
@@ -18,6 +20,21 @@ enum ZoneType {
 struct Config{
 	std::string RegionLayout;
 	int timeLimit, refreshRate;
+	bool nearestMatching; // take workers/goods from the nearest supplier by road instead of scan order
+	std::string historyFile; // run history is recorded here when set
+	int keyframeInterval;
+	int overviewZoom; // 0 prints every cell, otherwise the zoom level of the overview map
+};
+
+// Nearest live supplier of one zone type for every cell, by road distance. Built
+// by a multi-source BFS from all live suppliers along road cells; when a cell
+// changes, only the part of the BFS forest that was reached through it is redone.
+struct SupplierIndex {
+    ZoneType supplierZone;
+    std::vector<int> supplier;  // per cell: nearest live supplier cell, -1 if none is reachable
+    std::vector<int> distance;  // per cell: steps to that supplier
+    std::vector<int> parent;    // per cell: cell it was reached from, -1 for suppliers and unreached cells
+    std::vector<bool> live;     // per cell: supplier that currently has something to give
 };
 
 struct Cell {
@@ -38,10 +55,69 @@ struct Stats {
     int totalPollution = 0;
 };
 
+// Grid of cells stored as shared rows so forked simulations can share them.
+// Reads go through operator[]; writes must go through edit(), which copies a
+// row first unless this map created it since its last fork (copy-on-write).
+class RegionMap{
+private:
+    struct Row {
+        std::vector<Cell> cells;
+        unsigned long owner;  // id of the map allowed to write this row in place
+    };
+    std::vector<std::shared_ptr<Row>> rows;
+    unsigned long id;
+
+    // optional log of the cells written through edit(), each listed once
+    bool trackingEdits = false;
+    std::vector<int> editedCells;  // row-major cell indices
+    std::vector<bool> edited;
+
+public:
+    // iterates rows read-only, for range-based for loops
+    class RowIterator{
+    private:
+        std::vector<std::shared_ptr<Row>>::const_iterator it;
+    public:
+        RowIterator(std::vector<std::shared_ptr<Row>>::const_iterator it) : it(it) {}
+        const std::vector<Cell>& operator*() const { return (*it)->cells; }
+        RowIterator& operator++() { ++it; return *this; }
+        bool operator!=(const RowIterator& other) const { return it != other.it; }
+    };
+
+    RegionMap();
+    RegionMap(RegionMap&&) = default;
+    RegionMap& operator=(RegionMap&&) = default;
+    RegionMap(const RegionMap&) = delete;             // use fork() so both sides stop writing in place
+    RegionMap& operator=(const RegionMap&) = delete;
+
+    // share every row with a new map; later writes on either side copy the row first
+    RegionMap fork();
+
+    void push_back(const std::vector<Cell>& row);
+    void assign(const std::vector<std::vector<Cell>>& grid);
+    size_t size() const { return rows.size(); }
+    bool empty() const { return rows.empty(); }
+
+    const std::vector<Cell>& operator[](size_t x) const { return rows[x]->cells; }
+    Cell& edit(size_t x, size_t y);
+
+    // start logging edited cells, e.g. so the overview can update only those
+    void trackEdits();
+    const std::vector<int>& getEditedCells() const { return editedCells; }
+    void clearEdits();
+
+    RowIterator begin() const { return RowIterator(rows.begin()); }
+    RowIterator end() const { return RowIterator(rows.end()); }
+};
+
+class RunHistory;
+class OverviewRenderer;
+
 class Simulation{
 protected:
     Config config;
-    std::vector<std::vector<Cell>> regionMap;
+    RegionMap regionMap;
+    int currentTick = 0;
 
     // functions to manip private members
     bool readConfig(const std::string& path);
@@ -51,7 +127,7 @@ protected:
     int countAdjPop(int x, int y, int minPopulation) const;
 
     // functions for power
-    void findPowerPlant(std::vector<std::pair<int, int>>& powerPlants);
+    void findPowerPlant();  // fills powerPlants
     void bfsPowerPropagation(int startX, int startY);
     void markPowered();
     bool hasAdjPower(int x, int y) const;
@@ -69,25 +145,72 @@ protected:
 
     // Resource management
     int countAvailableWorkers() const;
-    void assignWorkerToJob();
+    void assignWorkerToJob(int x, int y);    // (x, y) is the cell receiving the workers
     int countAvailableGoods() const;         // New method to count available goods
-    void assignGoodToCell();                 // New method to deduct goods
+    void assignGoodToCell(int x, int y);     // (x, y) is the cell receiving the good
+
+    // nearest-supplier matching along the road network
+    SupplierIndex workerSuppliers{RESIDENTIAL, {}, {}, {}, {}};
+    SupplierIndex goodsSuppliers{INDUSTRIAL, {}, {}, {}, {}};
+    std::vector<int> roadQueue;   // BFS frontier
+    std::vector<int> roadSeeds;   // labelled cells a repair restarts from, sorted by distance
+    std::vector<int> resetCells;  // cells whose label a repair dropped
+    bool isLiveSupplier(const SupplierIndex& index, int x, int y) const;
+    bool carriesSupply(const SupplierIndex& index, int cell) const;
+    void buildSupplierIndex(SupplierIndex& index);
+    void relaxSupplierIndex(SupplierIndex& index);
+    void repairSupplierIndex(SupplierIndex& index, int cell);
+    int nearestSupplier(SupplierIndex& index, int x, int y);
+    void supplyChanged(int x, int y, bool zoneChanged = false);
+
+    // per-tick run history, only created when the config names a history file
+    std::unique_ptr<RunHistory> history;
+
+    // downsampled map used by printMap() when an overview zoom is configured
+    std::unique_ptr<OverviewRenderer> overview;
     
     // Change detection
+    bool populationChanged = false;  // set by the growth rules whenever a cell grows
     bool detectChanges();
 
+    // per-tick scratch buffers, sized once and reused so a steady-state tick does not allocate
+    std::vector<std::pair<int, int>> powerPlants;
+    std::vector<std::pair<int, int>> powerQueue;
+    std::vector<std::tuple<int, int, int>> pollutionQueue;
+    std::vector<std::tuple<int, int, int>> growthCandidates;
+    void reserveScratch();
+
 public:
     Simulation();
+    ~Simulation();
     void initializeSim(const std::string& configFilePath);
     void updatePower();
 
+    // run one timestep; returns false once the map has stopped changing
+    bool step();
+    int getCurrentTick() const;
+
+    // branch this simulation at the current tick; unchanged rows stay shared
+    // with the parent until either side modifies them. Must not run while this
+    // simulation is stepping; the parent and its forks may then step concurrently.
+    std::unique_ptr<Simulation> fork();
+    // rezone one cell (e.g. add a power plant); the cell starts empty of people and goods
+    void setZone(int x, int y, ZoneType zone);
+
     // printing functions
     void printConfig() const;
     void printMap() const;
+    void printOverview(int zoom, int top, int left, int height, int width) const;
     void printResults() const;
 
     // function that actually runs simulation
     void simulate();
+
+    // recorded history of the run, or nullptr if history is disabled
+    RunHistory* getHistory() const;
+
+    // read-only view of the current map
+    const RegionMap& getMap() const;
 };
 
 #endif
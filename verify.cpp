@@ -0,0 +1,215 @@
+#include "verify.h"
+#include "reference.h"
+
+#include <iostream>
+#include <random>
+#include <thread>
+
+// tick phases in simulate() order
+static const char* const phaseNames[] = {
+    "updatePower", "residentialGrowth", "industrialGrowth", "commercialGrowth", "spreadPollution"
+};
+static const int phaseCount = 5;
+
+// Simulation with its tick phases exposed so they can be stepped one at a time
+class VerifiedSimulation : public Simulation {
+public:
+    VerifiedSimulation(const std::vector<std::vector<Cell>>& layout) {
+        regionMap.assign(layout);
+        reserveScratch();
+    }
+
+    void runPhase(int phase) {
+        switch (phase) {
+            case 0: updatePower(); break;
+            case 1: residentialGrowth(); break;
+            case 2: industrialGrowth(); break;
+            case 3: commercialGrowth(); break;
+            case 4: spreadPollution(); break;
+        }
+    }
+
+    const Cell& cellAt(int x, int y) const {
+        return regionMap[x][y];
+    }
+};
+
+static void runPhase(ReferenceEngine& engine, int phase) {
+    switch (phase) {
+        case 0: engine.updatePower(); break;
+        case 1: engine.residentialGrowth(); break;
+        case 2: engine.industrialGrowth(); break;
+        case 3: engine.commercialGrowth(); break;
+        case 4: engine.spreadPollution(); break;
+    }
+}
+
+// name of the first field that differs between two cells, or nullptr if equal
+static const char* firstDifference(const Cell& a, const Cell& b) {
+    if (a.zone != b.zone) return "zone";
+    if (a.population != b.population) return "population";
+    if (a.pollution != b.pollution) return "pollution";
+    if (a.availableWorkers != b.availableWorkers) return "availableWorkers";
+    if (a.availableGoods != b.availableGoods) return "availableGoods";
+    if (a.isAdjacentToPowerLine != b.isAdjacentToPowerLine) return "isAdjacentToPowerLine";
+    if (a.isPowered != b.isPowered) return "isPowered";
+    return nullptr;
+}
+
+static void printCell(const Cell& cell) {
+    std::cerr << "zone '" << static_cast<char>(cell.zone) << "', population " << cell.population
+              << ", pollution " << cell.pollution << ", workers " << cell.availableWorkers
+              << ", goods " << cell.availableGoods << ", powered " << cell.isPowered;
+}
+
+bool verifyLayout(const std::vector<std::vector<Cell>>& layout, int ticks) {
+    VerifiedSimulation sim(layout);
+    ReferenceEngine reference(layout);
+
+    for (int tick = 1; tick <= ticks; tick++) {
+        for (int phase = 0; phase < phaseCount; phase++) {
+            sim.runPhase(phase);
+            runPhase(reference, phase);
+
+            // compare the full grid after every phase
+            const std::vector<std::vector<Cell>>& expected = reference.getMap();
+            for (size_t x = 0; x < expected.size(); x++) {
+                for (size_t y = 0; y < expected[x].size(); y++) {
+                    const Cell& actual = sim.cellAt(x, y);
+                    const char* field = firstDifference(actual, expected[x][y]);
+                    if (field) {
+                        std::cerr << "Divergence at tick " << tick << ", phase " << phaseNames[phase]
+                                  << ", cell (" << x << ", " << y << "), field " << field << "\n";
+                        std::cerr << "  optimized: ";
+                        printCell(actual);
+                        std::cerr << "\n  reference: ";
+                        printCell(expected[x][y]);
+                        std::cerr << std::endl;
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// compare two maps cell by cell, printing the first difference
+static bool sameMap(const RegionMap& actual, const RegionMap& expected, const char* what, int tick) {
+    for (size_t x = 0; x < expected.size(); x++) {
+        for (size_t y = 0; y < expected[x].size(); y++) {
+            const char* field = firstDifference(actual[x][y], expected[x][y]);
+            if (field) {
+                std::cerr << "Fork divergence at tick " << tick << ": " << what << ", cell ("
+                          << x << ", " << y << "), field " << field << "\n";
+                std::cerr << "  actual:   ";
+                printCell(actual[x][y]);
+                std::cerr << "\n  expected: ";
+                printCell(expected[x][y]);
+                std::cerr << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool verifyForks(const std::vector<std::vector<Cell>>& layout, int ticks, unsigned int seed) {
+    // control never forks, so it shows what the parent must look like
+    VerifiedSimulation parent(layout);
+    VerifiedSimulation control(layout);
+
+    int forkTick = ticks / 3;
+    for (int tick = 1; tick <= forkTick; tick++) {
+        parent.step();
+        control.step();
+    }
+
+    // twin is left alone; branch gets a few random rezonings
+    std::unique_ptr<Simulation> twin = parent.fork();
+    std::unique_ptr<Simulation> branch = parent.fork();
+    std::mt19937 rng(seed);
+    const ZoneType zones[] = {RESIDENTIAL, COMMERCIAL, INDUSTRIAL, ROAD, POWERLINE, POWERLINE_OVER_ROAD, POWERPLANT, EMPTY};
+    for (int edit = 0; edit < 3; edit++) {
+        branch->setZone(rng() % layout.size(), rng() % layout[0].size(), zones[rng() % 8]);
+    }
+
+    for (int tick = forkTick + 1; tick <= ticks; tick++) {
+        std::thread twinStep([&twin] { twin->step(); });
+        std::thread branchStep([&branch] { branch->step(); });
+        parent.step();
+        twinStep.join();
+        branchStep.join();
+        control.step();
+
+        if (!sameMap(parent.getMap(), control.getMap(), "parent changed by a branch", tick) ||
+            !sameMap(twin->getMap(), parent.getMap(), "unedited fork differs from parent", tick)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// road grid every 5 cells with a powered spine down column 0 and random zone blocks
+std::vector<std::vector<Cell>> generateLayout(std::mt19937& rng) {
+    std::uniform_int_distribution<int> size(6, 40);
+    int rows = size(rng), cols = size(rng);
+    const ZoneType blockZones[] = {RESIDENTIAL, RESIDENTIAL, COMMERCIAL, INDUSTRIAL, EMPTY};
+    std::uniform_int_distribution<int> pick(0, 4);
+
+    std::vector<std::vector<ZoneType>> blocks(rows / 5 + 1, std::vector<ZoneType>(cols / 5 + 1));
+    for (auto& row : blocks) {
+        for (auto& zone : row) {
+            zone = blockZones[pick(rng)];
+        }
+    }
+
+    std::vector<std::vector<Cell>> layout(rows, std::vector<Cell>(cols));
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            bool road = (x % 5 == 4) || (y % 5 == 4);
+            if (y == 0) {
+                layout[x][y].zone = road ? POWERLINE_OVER_ROAD : POWERLINE;
+            } else {
+                layout[x][y].zone = road ? ROAD : blocks[x / 5][y / 5];
+            }
+        }
+    }
+    layout[0][0].zone = POWERPLANT;
+    return layout;
+}
+
+// every cell drawn independently, weighted towards zoned cells
+std::vector<std::vector<Cell>> fuzzLayout(std::mt19937& rng) {
+    std::uniform_int_distribution<int> size(1, 32);
+    int rows = size(rng), cols = size(rng);
+    const ZoneType zones[] = {RESIDENTIAL, COMMERCIAL, INDUSTRIAL, ROAD, POWERLINE, POWERLINE_OVER_ROAD, POWERPLANT, EMPTY};
+    std::discrete_distribution<int> pick({25, 15, 15, 15, 10, 5, 2, 13});
+
+    std::vector<std::vector<Cell>> layout(rows, std::vector<Cell>(cols));
+    for (auto& row : layout) {
+        for (auto& cell : row) {
+            cell.zone = zones[pick(rng)];
+        }
+    }
+    return layout;
+}
+
+bool verifyEngines(int layoutCount, unsigned int seed, int ticks) {
+    std::mt19937 rng(seed);
+
+    for (int i = 0; i < layoutCount; i++) {
+        bool generated = (i % 2 == 0);
+        std::vector<std::vector<Cell>> layout = generated ? generateLayout(rng) : fuzzLayout(rng);
+
+        if (!verifyLayout(layout, ticks) || !verifyForks(layout, ticks, seed + i)) {
+            std::cerr << "Layout " << i << " (" << (generated ? "generated" : "fuzzed") << ", "
+                      << layout.size() << "x" << layout[0].size() << ", seed " << seed << ") failed." << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Verified " << layoutCount << " layouts over " << ticks
+              << " ticks: optimized and reference engines match, forks are isolated." << std::endl;
+    return true;
+}
@@ -0,0 +1,28 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include<random>
+#include<vector>
+
+#include "simulation.h"
+
+// Run Simulation and the frozen ReferenceEngine in lockstep on one layout,
+// comparing the whole grid after every phase of every tick. Prints the first
+// diverging tick, phase and cell and returns false on a mismatch.
+bool verifyLayout(const std::vector<std::vector<Cell>>& layout, int ticks);
+
+// Fork checks on one layout: a fork with no edits must stay identical to its
+// parent, and edits to another fork must never reach the parent. The forks
+// step on their own threads while the parent steps.
+bool verifyForks(const std::vector<std::vector<Cell>>& layout, int ticks, unsigned int seed);
+
+// road-grid layout with a power spine and random zone blocks, 6 to 40 cells a side
+std::vector<std::vector<Cell>> generateLayout(std::mt19937& rng);
+
+// every cell drawn independently, 1 to 32 cells a side
+std::vector<std::vector<Cell>> fuzzLayout(std::mt19937& rng);
+
+// verifyLayout() and verifyForks() over generated (road grid) and fuzzed (random) layouts
+bool verifyEngines(int layoutCount, unsigned int seed, int ticks);
+
+#endif